@@ -6,6 +6,17 @@
 #include <limits>
 #include <algorithm> // Для std::max
 #include <fstream>   // Для чтения файлов
+#include <array>     // Для систем фиксированного размера
+#include <type_traits>
+#include <utility>
+#include <charconv>  // Для быстрого форматирования чисел
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <random>
 
 using namespace std;
 
@@ -32,9 +43,24 @@ struct OperationCounter
       cout << "Извлечения корней: " << square_roots << endl;
       cout << "Перестановки строк: " << swaps << endl;
    }
+
+   OperationCounter &operator+=(const OperationCounter &other)
+   {
+      additions += other.additions;
+      multiplications += other.multiplications;
+      divisions += other.divisions;
+      square_roots += other.square_roots;
+      swaps += other.swaps;
+      return *this;
+   }
 };
 
-OperationCounter opCount;
+// Счетчик свой у каждого потока, чтобы решатели конвейера не мешали друг другу
+thread_local OperationCounter opCount;
+
+// Причина последней неудачи решателя в текущем потоке. Решатели сами ничего
+// не печатают, сообщение выводит вызывающий код
+thread_local const char *solverError = "";
 
 // Структура профильной матрицы
 struct ProfileMatrix
@@ -171,10 +197,511 @@ vector<vector<double>> generateHilbertMatrix(int n)
    return H;
 }
 
+// ================== Системы малого фиксированного размера ==================
+
+// Максимальный размер системы, для которого используются специализации
+// с хранением на стеке (std::array) вместо vector<vector<double>>
+constexpr size_t MAX_FIXED_SIZE = 8;
+
+// Количество систем, обрабатываемых пакетными решателями за один проход
+constexpr size_t SMALL_BATCH_TILE = 32;
+
+// Наибольшее число копий каждой системы в пакетном режиме меню: пакет
+// и эталонные решения занимают несколько килобайт на систему
+constexpr int MAX_BATCH_COPIES = 100000;
+
+// Вызов func(integral_constant<size_t, N>()) для специализации N == n.
+// Возвращает false, если n > MAX_FIXED_SIZE и специализации нет
+template <size_t N = 1, typename Func>
+bool dispatchFixedSize(int n, Func &&func)
+{
+   if constexpr (N > MAX_FIXED_SIZE)
+   {
+      return false;
+   }
+   else
+   {
+      if (n == static_cast<int>(N))
+      {
+         func(integral_constant<size_t, N>());
+         return true;
+      }
+      return dispatchFixedSize<N + 1>(n, forward<Func>(func));
+   }
+}
+
+template <size_t N>
+using FixedMatrix = array<array<double, N>, N>;
+
+template <size_t N>
+using FixedVector = array<double, N>;
+
+// Модуль числа, пригодный для вычислений на этапе компиляции
+constexpr double fixedAbs(double value)
+{
+   return value < 0 ? -value : value;
+}
+
+// Преобразование профильной матрицы в матрицу фиксированного размера
+template <size_t N>
+FixedMatrix<N> profileToFixed(const ProfileMatrix &profile)
+{
+   FixedMatrix<N> A{};
+   for (size_t i = 0; i < N; i++)
+   {
+      size_t start = profile.first_non_zero[i];
+      for (size_t j = start; j < N; j++)
+      {
+         A[i][j] = profile.rows[i][j - start];
+      }
+   }
+   return A;
+}
+
+// Преобразование матрицы фиксированного размера в профильную
+template <size_t N>
+ProfileMatrix fixedToProfile(const FixedMatrix<N> &A)
+{
+   ProfileMatrix profile(N);
+   for (size_t i = 0; i < N; i++)
+   {
+      size_t first = 0;
+      while (first < N && abs(A[i][first]) < numeric_limits<double>::epsilon())
+      {
+         first++;
+      }
+      profile.first_non_zero[i] = first;
+      profile.rows[i].assign(A[i].begin() + first, A[i].end());
+   }
+   return profile;
+}
+
+// LU(sq)-разложение матрицы фиксированного размера на месте.
+// Так как U[k][j] == L[j][k], хватает одной матрицы L; результат совпадает
+// с LU_SQ_Decomposition для профильной матрицы (L на и под диагональю, выше - нули)
+template <size_t N>
+bool LU_SQ_Decomposition(FixedMatrix<N> &A, OperationCounter &ops)
+{
+#pragma GCC unroll 8
+   for (size_t i = 0; i < N; i++)
+   {
+#pragma GCC unroll 8
+      for (size_t j = 0; j < i; j++)
+      {
+         double sum = 0.0;
+#pragma GCC unroll 8
+         for (size_t k = 0; k < j; k++)
+         {
+            sum += A[i][k] * A[j][k];
+         }
+         A[i][j] = (A[j][i] - sum) / A[j][j];
+         ops.additions += j + 1;
+         ops.multiplications += j + 1;
+         ops.divisions += 1;
+      }
+
+      double sum = 0.0;
+#pragma GCC unroll 8
+      for (size_t k = 0; k < i; k++)
+      {
+         sum += A[i][k] * A[i][k];
+      }
+      ops.additions += i;
+      ops.multiplications += i;
+      double value = A[i][i] - sum;
+      if (value <= 0)
+      {
+         solverError = "Matrix is NOT LU(sq) decomposable!";
+         return false;
+      }
+      A[i][i] = sqrt(value);
+      ops.square_roots += 1;
+   }
+
+#pragma GCC unroll 8
+   for (size_t i = 0; i < N; i++)
+   {
+#pragma GCC unroll 8
+      for (size_t j = i + 1; j < N; j++)
+      {
+         A[i][j] = 0.0;
+      }
+   }
+   return true;
+}
+
+// Метод Гаусса с выбором ведущего элемента для системы фиксированного размера.
+// A и b передаются по значению и остаются на стеке; функция допускает
+// вычисление на этапе компиляции для невырожденных систем
+template <size_t N>
+constexpr bool GaussianEliminationPartialPivoting(FixedMatrix<N> A, FixedVector<N> b, FixedVector<N> &solution, OperationCounter &ops)
+{
+#pragma GCC unroll 8
+   for (size_t i = 0; i < N; i++)
+   {
+      // Поиск максимального элемента для частичного выбора ведущего
+      size_t maxRow = i;
+      double maxElem = fixedAbs(A[i][i]);
+#pragma GCC unroll 8
+      for (size_t k = i + 1; k < N; k++)
+      {
+         if (fixedAbs(A[k][i]) > maxElem)
+         {
+            maxElem = fixedAbs(A[k][i]);
+            maxRow = k;
+         }
+      }
+
+      if (maxElem < numeric_limits<double>::epsilon())
+      {
+         solverError = "Матрица вырождена!";
+         return false;
+      }
+
+      // Перестановка строк (левее столбца i обе строки уже нулевые)
+      if (maxRow != i)
+      {
+#pragma GCC unroll 8
+         for (size_t j = i; j < N; j++)
+         {
+            double tmp = A[i][j];
+            A[i][j] = A[maxRow][j];
+            A[maxRow][j] = tmp;
+         }
+         double tmp = b[i];
+         b[i] = b[maxRow];
+         b[maxRow] = tmp;
+         ops.swaps += 1;
+      }
+
+      // Приведение к верхнетреугольному виду
+#pragma GCC unroll 8
+      for (size_t k = i + 1; k < N; k++)
+      {
+         double factor = A[k][i] / A[i][i];
+         A[k][i] = 0.0;
+#pragma GCC unroll 8
+         for (size_t j = i + 1; j < N; j++)
+         {
+            A[k][j] -= factor * A[i][j];
+         }
+         b[k] -= factor * b[i];
+         ops.divisions += 1;
+         ops.multiplications += N - i;
+         ops.additions += N - i;
+      }
+   }
+
+   // Обратный ход
+#pragma GCC unroll 8
+   for (size_t r = 0; r < N; r++)
+   {
+      size_t i = N - 1 - r;
+      solution[i] = b[i];
+#pragma GCC unroll 8
+      for (size_t j = i + 1; j < N; j++)
+      {
+         solution[i] -= A[i][j] * solution[j];
+      }
+      solution[i] /= A[i][i];
+      ops.multiplications += N - i - 1;
+      ops.additions += N - i - 1;
+      ops.divisions += 1;
+   }
+   return true;
+}
+
+// LU(sq)-разложение профильной матрицы через специализацию размера N
+template <size_t N>
+bool LU_SQ_DecompositionFixed(ProfileMatrix &profileA)
+{
+   FixedMatrix<N> A = profileToFixed<N>(profileA);
+   OperationCounter ops;
+   bool decomposed = LU_SQ_Decomposition(A, ops);
+   opCount += ops;
+   if (decomposed)
+   {
+      profileA = fixedToProfile(A);
+   }
+   return decomposed;
+}
+
+// Метод Гаусса для профильной матрицы через специализацию размера N
+template <size_t N>
+bool GaussianEliminationFixed(const ProfileMatrix &profileA, const vector<double> &b, vector<double> &solution)
+{
+   FixedVector<N> fixedB{};
+   copy(b.begin(), b.begin() + N, fixedB.begin());
+   FixedVector<N> x{};
+   OperationCounter ops;
+   bool solved = GaussianEliminationPartialPivoting(profileToFixed<N>(profileA), fixedB, x, ops);
+   opCount += ops;
+   if (solved)
+   {
+      solution.assign(x.begin(), x.end());
+   }
+   return solved;
+}
+
+// Пакет однотипных систем размера N, разбитый на плитки по SMALL_BATCH_TILE
+// систем. Внутри плитки элемент (i, j) системы с номером lane в плитке хранится
+// в v[i][j][lane]: одна и та же операция над всеми системами плитки идет по
+// соседним адресам, и пакетные решатели работают прямо с плитками, без копирования
+template <size_t N>
+struct SmallSystemBatch
+{
+   struct alignas(64) MatrixTile
+   {
+      double v[N][N][SMALL_BATCH_TILE];
+   };
+   struct alignas(64) VectorTile
+   {
+      double v[N][SMALL_BATCH_TILE];
+   };
+
+   size_t count;          // Количество систем
+   vector<MatrixTile> a;  // Матрицы систем
+   vector<VectorTile> b;  // Правые части
+   vector<VectorTile> x;  // Решения (метод Гаусса)
+   vector<MatrixTile> l;  // Разложения (LU(sq)), выше диагонали остаются нули
+   vector<char> ok;       // Признак успешного решения каждой системы
+
+   // Все места, включая недостающие до целой плитки, заполняются единичными
+   // системами с нулевой правой частью, чтобы все циклы по системам плитки
+   // имели постоянную длину
+   SmallSystemBatch(size_t size = 0)
+       : count(size), a(tileCount()), b(tileCount()), x(tileCount()), l(tileCount()), ok(size, 0)
+   {
+      for (MatrixTile &tile : a)
+      {
+         for (size_t i = 0; i < N; i++)
+         {
+            for (size_t j = 0; j < N; j++)
+            {
+               for (size_t s = 0; s < SMALL_BATCH_TILE; s++)
+                  tile.v[i][j][s] = i == j ? 1.0 : 0.0;
+            }
+         }
+      }
+   }
+
+   size_t tileCount() const { return (count + SMALL_BATCH_TILE - 1) / SMALL_BATCH_TILE; }
+
+   double &matrix(size_t i, size_t j, size_t s) { return a[s / SMALL_BATCH_TILE].v[i][j][s % SMALL_BATCH_TILE]; }
+   double &rhs(size_t i, size_t s) { return b[s / SMALL_BATCH_TILE].v[i][s % SMALL_BATCH_TILE]; }
+   double &result(size_t i, size_t s) { return x[s / SMALL_BATCH_TILE].v[i][s % SMALL_BATCH_TILE]; }
+   double &factor(size_t i, size_t j, size_t s) { return l[s / SMALL_BATCH_TILE].v[i][j][s % SMALL_BATCH_TILE]; }
+};
+
+// Учет операций пакета: счетчики одной системы perSystem добавляются для каждой
+// успешно решенной системы плитки, перестановки - по фактическому числу у каждой.
+// Системы, решение которых не удалось, в счетчики не попадают
+void addBatchOperations(OperationCounter &ops, const OperationCounter &perSystem, const char *ok, const double *swaps, size_t width)
+{
+   long long solved = 0;
+   double solvedSwaps = 0.0;
+   for (size_t s = 0; s < width; s++)
+   {
+      solved += ok[s] != 0;
+      solvedSwaps += ok[s] ? swaps[s] : 0.0;
+   }
+   ops.additions += perSystem.additions * solved;
+   ops.multiplications += perSystem.multiplications * solved;
+   ops.divisions += perSystem.divisions * solved;
+   ops.square_roots += perSystem.square_roots * solved;
+   ops.swaps += perSystem.swaps * solved + static_cast<long long>(solvedSwaps);
+}
+
+// Пакетное LU(sq)-разложение: матрицы batch.a только читаются, разложение каждой
+// системы записывается в batch.l, признак успеха - в batch.ok. Для неразложимых
+// систем содержимое batch.l не определено
+template <size_t N>
+void LU_SQ_DecompositionBatch(SmallSystemBatch<N> &batch, OperationCounter &ops)
+{
+   const size_t T = SMALL_BATCH_TILE;
+   for (size_t tile = 0; tile < batch.a.size(); tile++)
+   {
+      const double(&A)[N][N][T] = batch.a[tile].v;
+      double(&L)[N][N][T] = batch.l[tile].v;
+      size_t first = tile * T;
+      size_t width = min(T, batch.count - first);
+      double sum[T];
+      double value[T];
+      double minDiagonal[T];
+      double swaps[T] = {};
+      OperationCounter perSystem;
+      for (size_t s = 0; s < T; s++)
+         minDiagonal[s] = numeric_limits<double>::infinity();
+
+      for (size_t i = 0; i < N; i++)
+      {
+         for (size_t j = 0; j < i; j++)
+         {
+            for (size_t s = 0; s < T; s++)
+               sum[s] = 0.0;
+            for (size_t k = 0; k < j; k++)
+            {
+               for (size_t s = 0; s < T; s++)
+                  sum[s] += L[i][k][s] * L[j][k][s];
+            }
+            for (size_t s = 0; s < T; s++)
+               L[i][j][s] = (A[j][i][s] - sum[s]) / L[j][j][s];
+            perSystem.additions += j + 1;
+            perSystem.multiplications += j + 1;
+            perSystem.divisions += 1;
+         }
+
+         for (size_t s = 0; s < T; s++)
+            sum[s] = 0.0;
+         for (size_t k = 0; k < i; k++)
+         {
+            for (size_t s = 0; s < T; s++)
+               sum[s] += L[i][k][s] * L[i][k][s];
+         }
+         // Неразложимые системы продолжают считаться с единицей на диагонали.
+         // Каждый цикл содержит не более одного выбора, иначе GCC не векторизует его
+         for (size_t s = 0; s < T; s++)
+            value[s] = A[i][i][s] - sum[s];
+         for (size_t s = 0; s < T; s++)
+            minDiagonal[s] = min(minDiagonal[s], value[s]);
+         for (size_t s = 0; s < T; s++)
+            value[s] = value[s] <= 0 ? 1.0 : value[s];
+         for (size_t s = 0; s < T; s++)
+            L[i][i][s] = sqrt(value[s]);
+         perSystem.additions += i;
+         perSystem.multiplications += i;
+         perSystem.square_roots += 1;
+      }
+
+      for (size_t s = 0; s < width; s++)
+         batch.ok[first + s] = !(minDiagonal[s] <= 0);
+      addBatchOperations(ops, perSystem, &batch.ok[first], swaps, width);
+   }
+}
+
+// Пакетный метод Гаусса с выбором ведущего элемента. Матрицы и правые части
+// batch.a и batch.b служат рабочей памятью и приводятся к верхнетреугольному
+// виду на месте. Решения записываются в batch.x, признак невырожденности - в batch.ok
+template <size_t N>
+void GaussianEliminationBatch(SmallSystemBatch<N> &batch, OperationCounter &ops)
+{
+   const size_t T = SMALL_BATCH_TILE;
+   for (size_t tile = 0; tile < batch.a.size(); tile++)
+   {
+      double(&A)[N][N][T] = batch.a[tile].v;
+      double(&b)[N][T] = batch.b[tile].v;
+      double(&x)[N][T] = batch.x[tile].v;
+      size_t first = tile * T;
+      size_t width = min(T, batch.count - first);
+      double maxElem[T];
+      double maxRow[T]; // Номер ведущей строки, double - той же ширины, что и данные
+      double minPivot[T];
+      double factor[T];
+      double swaps[T] = {};
+      OperationCounter perSystem;
+      for (size_t s = 0; s < T; s++)
+         minPivot[s] = numeric_limits<double>::infinity();
+
+      for (size_t i = 0; i < N; i++)
+      {
+         // Поиск максимального элемента для частичного выбора ведущего.
+         // Номер строки и максимум обновляются в разных циклах: цикл с двумя
+         // выборами по одному условию GCC не векторизует
+         double rowI = i;
+         for (size_t s = 0; s < T; s++)
+         {
+            maxElem[s] = abs(A[i][i][s]);
+            maxRow[s] = rowI;
+         }
+         for (size_t k = i + 1; k < N; k++)
+         {
+            double rowK = k;
+            for (size_t s = 0; s < T; s++)
+            {
+               double current = maxRow[s];
+               maxRow[s] = abs(A[k][i][s]) > maxElem[s] ? rowK : current;
+            }
+            for (size_t s = 0; s < T; s++)
+               maxElem[s] = max(maxElem[s], abs(A[k][i][s]));
+         }
+         for (size_t s = 0; s < T; s++)
+            minPivot[s] = min(minPivot[s], maxElem[s]);
+         for (size_t s = 0; s < T; s++)
+            swaps[s] += maxRow[s] != rowI ? 1.0 : 0.0;
+
+         // Перестановка строк i и maxRow[s] прямо в плитке, отдельно для каждой
+         // системы (левее столбца i обе строки нулевые)
+         if constexpr (N > 1)
+         {
+            for (size_t s = 0; s < T; s++)
+            {
+               size_t row = static_cast<size_t>(maxRow[s]);
+               if (row == i)
+                  continue;
+               for (size_t j = i; j < N; j++)
+                  swap(A[i][j][s], A[row][j][s]);
+               swap(b[i][s], b[row][s]);
+            }
+         }
+
+         // Приведение к верхнетреугольному виду
+         for (size_t k = i + 1; k < N; k++)
+         {
+            for (size_t s = 0; s < T; s++)
+            {
+               factor[s] = A[k][i][s] / A[i][i][s];
+               A[k][i][s] = 0.0;
+            }
+            for (size_t j = i + 1; j < N; j++)
+            {
+               for (size_t s = 0; s < T; s++)
+                  A[k][j][s] -= factor[s] * A[i][j][s];
+            }
+            for (size_t s = 0; s < T; s++)
+               b[k][s] -= factor[s] * b[i][s];
+            perSystem.divisions += 1;
+            perSystem.multiplications += N - i;
+            perSystem.additions += N - i;
+         }
+      }
+
+      // Обратный ход
+      for (size_t r = 0; r < N; r++)
+      {
+         size_t i = N - 1 - r;
+         for (size_t s = 0; s < T; s++)
+            x[i][s] = b[i][s];
+         for (size_t j = i + 1; j < N; j++)
+         {
+            for (size_t s = 0; s < T; s++)
+               x[i][s] -= A[i][j][s] * x[j][s];
+         }
+         for (size_t s = 0; s < T; s++)
+            x[i][s] /= A[i][i][s];
+         perSystem.multiplications += N - i - 1;
+         perSystem.additions += N - i - 1;
+         perSystem.divisions += 1;
+      }
+
+      for (size_t s = 0; s < width; s++)
+         batch.ok[first + s] = !(minPivot[s] < numeric_limits<double>::epsilon());
+      addBatchOperations(ops, perSystem, &batch.ok[first], swaps, width);
+   }
+}
+
 // Функция LU-разложения для профильной матрицы с подсчетом операций
 bool LU_SQ_Decomposition(ProfileMatrix &profileA)
 {
    int n = profileA.n;
+
+   // Для маленьких систем используем специализации фиксированного размера
+   bool decomposed = false;
+   if (dispatchFixedSize(n, [&](auto size)
+                         { decomposed = LU_SQ_DecompositionFixed<decltype(size)::value>(profileA); }))
+   {
+      return decomposed;
+   }
+
    // Преобразуем профильную матрицу обратно в плотную
    vector<vector<double>> A = profileToDense(profileA);
    vector<vector<double>> L(n, vector<double>(n, 0.0));
@@ -198,7 +725,7 @@ bool LU_SQ_Decomposition(ProfileMatrix &profileA)
             // Проверка на отрицательное или нулевое значение перед извлечением корня
             if (value <= 0)
             {
-               cout << "Matrix is NOT LU(sq) decomposable!" << endl;
+               solverError = "Matrix is NOT LU(sq) decomposable!";
                return false;
             }
             L[j][j] = sqrt(value);
@@ -215,7 +742,7 @@ bool LU_SQ_Decomposition(ProfileMatrix &profileA)
             }
             if (L[j][j] == 0)
             {
-               cout << "Деление на ноль при LU-разложении!" << endl;
+               solverError = "Деление на ноль при LU-разложении!";
                return false;
             }
             U[j][i] = (A[j][i] - sum) / L[j][j];
@@ -258,6 +785,15 @@ bool LU_SQ_Decomposition(ProfileMatrix &profileA)
 bool GaussianEliminationPartialPivoting(ProfileMatrix &profileA, vector<double> &b, vector<double> &solution)
 {
    int n = profileA.n;
+
+   // Для маленьких систем используем специализации фиксированного размера
+   bool solved = false;
+   if (dispatchFixedSize(n, [&](auto size)
+                         { solved = GaussianEliminationFixed<decltype(size)::value>(profileA, b, solution); }))
+   {
+      return solved;
+   }
+
    // Преобразуем профильную матрицу обратно в плотную
    vector<vector<double>> A = profileToDense(profileA);
 
@@ -281,7 +817,7 @@ bool GaussianEliminationPartialPivoting(ProfileMatrix &profileA, vector<double>
 
       if (maxElem < numeric_limits<double>::epsilon())
       {
-         cout << "Матрица вырождена!" << endl;
+         solverError = "Матрица вырождена!";
          return false;
       }
 
@@ -487,6 +1023,576 @@ void displayCurrentTest(const TestCase &test, const ProfileMatrix &A, const vect
    cout << endl;
 }
 
+// Время в секундах, прошедшее с момента start
+double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// ================== Пакетный режим ==================
+
+// Пакетное решение всех тестов размера N, каждый из которых повторен copies раз.
+// Копии слегка возмущены, чтобы пакет и решатели фиксированного размера, с
+// которыми сверяются результаты и счетчики операций, обрабатывали одни и те же
+// count различных систем, а не несколько исходных, постоянно лежащих в кэше
+template <size_t N>
+void runSmallSystemBatch(const vector<TestCase> &tests, int copies)
+{
+   vector<FixedMatrix<N>> matrices;
+   vector<FixedVector<N>> vectors;
+   for (const TestCase &test : tests)
+   {
+      ProfileMatrix A;
+      vector<double> b;
+      int size = 0;
+      if (loadTest(test, A, b, size) && size == static_cast<int>(N))
+      {
+         FixedVector<N> fixedB{};
+         copy(b.begin(), b.end(), fixedB.begin());
+         matrices.push_back(profileToFixed<N>(A));
+         vectors.push_back(fixedB);
+      }
+   }
+
+   if (matrices.empty())
+   {
+      cout << "Нет загруженных тестов размера " << N << "." << endl;
+      return;
+   }
+
+   size_t count = matrices.size() * copies;
+   vector<FixedMatrix<N>> systems(count);
+   vector<FixedVector<N>> rhs(count);
+   mt19937 generator(static_cast<unsigned>(N));
+   uniform_real_distribution<double> perturbation(-1e-3, 1e-3);
+   for (size_t s = 0; s < count; s++)
+   {
+      systems[s] = matrices[s % matrices.size()];
+      rhs[s] = vectors[s % vectors.size()];
+      if (s < matrices.size())
+         continue; // Первая копия каждого теста остается исходной
+      // Симметричное относительное возмущение сохраняет симметрию матрицы
+      for (size_t i = 0; i < N; i++)
+      {
+         for (size_t j = 0; j <= i; j++)
+         {
+            double scale = 1.0 + perturbation(generator);
+            systems[s][i][j] *= scale;
+            if (j != i)
+               systems[s][j][i] *= scale;
+         }
+         rhs[s][i] *= 1.0 + perturbation(generator);
+      }
+   }
+
+   SmallSystemBatch<N> gaussBatch(count), luBatch(count);
+   for (size_t s = 0; s < count; s++)
+   {
+      const FixedMatrix<N> &A = systems[s];
+      const FixedVector<N> &b = rhs[s];
+      for (size_t i = 0; i < N; i++)
+      {
+         for (size_t j = 0; j < N; j++)
+         {
+            gaussBatch.matrix(i, j, s) = A[i][j];
+            luBatch.matrix(i, j, s) = A[i][j];
+         }
+         gaussBatch.rhs(i, s) = b[i];
+      }
+   }
+
+   // Пакетное решение
+   OperationCounter batchGaussOps, batchLUOps;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   GaussianEliminationBatch(gaussBatch, batchGaussOps);
+   double batchGaussSeconds = secondsSince(start);
+   start = chrono::steady_clock::now();
+   LU_SQ_DecompositionBatch(luBatch, batchLUOps);
+   double batchLUSeconds = secondsSince(start);
+
+   // Решение по одной системе специализациями фиксированного размера
+   vector<FixedVector<N>> solutions(count);
+   vector<FixedMatrix<N>> factors(count);
+   vector<char> solved(count), decomposed(count);
+   OperationCounter fixedGaussOps, fixedLUOps;
+   start = chrono::steady_clock::now();
+   for (size_t s = 0; s < count; s++)
+   {
+      OperationCounter ops;
+      solved[s] = GaussianEliminationPartialPivoting(systems[s], rhs[s], solutions[s], ops);
+      if (solved[s])
+         fixedGaussOps += ops;
+   }
+   double fixedGaussSeconds = secondsSince(start);
+   start = chrono::steady_clock::now();
+   for (size_t s = 0; s < count; s++)
+   {
+      OperationCounter ops;
+      factors[s] = systems[s];
+      decomposed[s] = LU_SQ_Decomposition(factors[s], ops);
+      if (decomposed[s])
+         fixedLUOps += ops;
+   }
+   double fixedLUSeconds = secondsSince(start);
+
+   // Сверка: признаки успеха, решения и разложения должны совпадать поразрядно
+   size_t mismatches = 0, solvedCount = 0, decomposedCount = 0;
+   for (size_t s = 0; s < count; s++)
+   {
+      mismatches += gaussBatch.ok[s] != solved[s];
+      mismatches += luBatch.ok[s] != decomposed[s];
+      solvedCount += solved[s] != 0;
+      decomposedCount += decomposed[s] != 0;
+      for (size_t i = 0; i < N; i++)
+      {
+         if (solved[s])
+            mismatches += gaussBatch.result(i, s) != solutions[s][i];
+         for (size_t j = 0; j < N && decomposed[s]; j++)
+         {
+            mismatches += luBatch.factor(i, j, s) != factors[s][i][j];
+         }
+      }
+   }
+   bool sameOps = batchGaussOps.additions == fixedGaussOps.additions &&
+                  batchGaussOps.multiplications == fixedGaussOps.multiplications &&
+                  batchGaussOps.divisions == fixedGaussOps.divisions &&
+                  batchGaussOps.swaps == fixedGaussOps.swaps &&
+                  batchLUOps.additions == fixedLUOps.additions &&
+                  batchLUOps.multiplications == fixedLUOps.multiplications &&
+                  batchLUOps.divisions == fixedLUOps.divisions &&
+                  batchLUOps.square_roots == fixedLUOps.square_roots;
+
+   cout << "Систем размера " << N << " в пакете: " << count
+        << " (тестов: " << matrices.size() << ", копий: " << copies << ")" << endl;
+   cout << fixed << setprecision(6);
+   cout << "Метод Гаусса: решено " << solvedCount << ", пакетно " << batchGaussSeconds
+        << " с, по одной системе " << fixedGaussSeconds << " с" << endl;
+   cout << "LU-разложение: выполнено " << decomposedCount << ", пакетно " << batchLUSeconds
+        << " с, по одной системе " << fixedLUSeconds << " с" << endl;
+   cout << "\nМетод Гаусса (пакет)" << endl;
+   batchGaussOps.print();
+   cout << "\nLU-разложение (пакет)" << endl;
+   batchLUOps.print();
+   if (mismatches == 0 && sameOps)
+   {
+      cout << "\nРезультаты пакетных решателей совпадают с решателями фиксированного размера." << endl;
+   }
+   else
+   {
+      cout << "\nРасхождений с решателями фиксированного размера: " << mismatches
+           << (sameOps ? "" : ", счетчики операций различаются") << endl;
+   }
+}
+
+// Пакетный режим для тестов размера size. Возвращает false, если для
+// этого размера нет специализации фиксированного размера
+bool runSmallSystemBatch(const vector<TestCase> &tests, int size, int copies)
+{
+   return dispatchFixedSize(size, [&](auto fixedSize)
+                            { runSmallSystemBatch<decltype(fixedSize)::value>(tests, copies); });
+}
+
+// ================== Конвейерный режим ==================
+
+// Статистика ограниченной очереди между этапами конвейера
+struct QueueStats
+{
+   size_t capacity = 0;
+   size_t maxOccupancy = 0;   // Максимальное число элементов в очереди
+   double occupancySum = 0.0; // Сумма заполненности по всем добавлениям
+   long long pushes = 0;
+   long long fullWaits = 0;  // Сколько раз производитель ждал места
+   long long emptyWaits = 0; // Сколько раз потребитель ждал элемента
+
+   double averageOccupancy() const
+   {
+      return pushes > 0 ? occupancySum / pushes : 0.0;
+   }
+};
+
+// Ограниченная очередь между этапами конвейера. Производитель блокируется,
+// пока очередь заполнена; после close() потребители дочитывают остаток
+template <typename T>
+struct BoundedQueue
+{
+   deque<T> items;
+   mutex lock;
+   condition_variable notFull;
+   condition_variable notEmpty;
+   bool closed = false;
+   QueueStats stats;
+
+   BoundedQueue(size_t capacity) { stats.capacity = capacity; }
+
+   void push(T item)
+   {
+      unique_lock<mutex> guard(lock);
+      if (items.size() >= stats.capacity)
+      {
+         stats.fullWaits += 1;
+         notFull.wait(guard, [this]
+                      { return items.size() < stats.capacity; });
+      }
+      items.push_back(move(item));
+      stats.pushes += 1;
+      stats.occupancySum += items.size();
+      stats.maxOccupancy = max(stats.maxOccupancy, items.size());
+      notEmpty.notify_one();
+   }
+
+   // Возвращает false, если очередь закрыта и пуста
+   bool pop(T &item)
+   {
+      unique_lock<mutex> guard(lock);
+      if (items.empty() && !closed)
+      {
+         stats.emptyWaits += 1;
+         notEmpty.wait(guard, [this]
+                       { return !items.empty() || closed; });
+      }
+      if (items.empty())
+         return false;
+      item = move(items.front());
+      items.pop_front();
+      notFull.notify_one();
+      return true;
+   }
+
+   void close()
+   {
+      lock_guard<mutex> guard(lock);
+      closed = true;
+      notEmpty.notify_all();
+   }
+};
+
+// Окно упорядочивания: загрузчик не выдает систему index, пока этап вывода не
+// записал все системы до index - size. Поэтому в буфере восстановления порядка
+// pipelineWriter никогда не бывает больше size результатов, даже если один
+// из решателей надолго задержался
+struct PipelineWindow
+{
+   mutex lock;
+   condition_variable advanced;
+   size_t size;
+   size_t written = 0;     // Сколько систем этап вывода уже записал по порядку
+   size_t maxPending = 0;  // Максимальный размер буфера восстановления порядка
+   long long waits = 0;    // Сколько раз загрузчик ждал продвижения окна
+
+   PipelineWindow(size_t windowSize) : size(windowSize) {}
+
+   void acquire(size_t index)
+   {
+      unique_lock<mutex> guard(lock);
+      if (index >= written + size)
+      {
+         waits += 1;
+         advanced.wait(guard, [this, index]
+                       { return index < written + size; });
+      }
+   }
+
+   void release(size_t count)
+   {
+      lock_guard<mutex> guard(lock);
+      written += count;
+      advanced.notify_all();
+   }
+};
+
+// Статистика одного потока этапа конвейера
+struct StageStats
+{
+   long long items = 0;
+   double busySeconds = 0.0; // Время работы без ожидания очередей
+
+   StageStats &operator+=(const StageStats &other)
+   {
+      items += other.items;
+      busySeconds += other.busySeconds;
+      return *this;
+   }
+};
+
+// Загруженная система, передаваемая от загрузчика решателям
+struct PipelineTask
+{
+   size_t index = 0;
+   const TestCase *test = nullptr;
+   bool loaded = false;
+   ProfileMatrix A;
+   vector<double> b;
+};
+
+// Результат решения, передаваемый от решателей этапу вывода
+struct PipelineResult
+{
+   size_t index = 0;
+   const TestCase *test = nullptr;
+   bool loaded = false;
+   bool success = false;
+   const char *error = ""; // Причина неудачи решателя
+   ProfileMatrix matrix;     // LU-разложение (алгоритм 1)
+   vector<double> solution; // Решение системы (алгоритм 2)
+   OperationCounter ops;
+};
+
+// Форматирование числа в буфер так же, как setw(10) << fixed << setprecision(4)
+void appendNumber(string &out, double value)
+{
+   char cell[400];
+   to_chars_result converted = to_chars(cell, cell + sizeof(cell), value, chars_format::fixed, 4);
+   size_t len = converted.ptr - cell;
+   if (len < 10)
+      out.append(10 - len, ' ');
+   out.append(cell, len);
+   out += ' ';
+}
+
+// Форматирование вектора в буфер в том же виде, что и printVector
+void appendVector(string &out, const vector<double> &vec)
+{
+   for (double v : vec)
+      appendNumber(out, v);
+   out += '\n';
+}
+
+// Форматирование профильной матрицы в буфер в том же виде, что и printMatrix
+void appendMatrix(string &out, const ProfileMatrix &profile)
+{
+   for (int i = 0; i < profile.n; i++)
+   {
+      for (int j = 0; j < profile.n; j++)
+         appendNumber(out, getProfileElement(profile, i, j));
+      out += '\n';
+   }
+}
+
+// Форматирование результата одной системы для файла вывода конвейера
+void appendResult(string &out, const PipelineResult &result, int algorithm)
+{
+   out += "--- Система " + to_string(result.index + 1) + ": " + result.test->name + " ---\n";
+   if (!result.loaded)
+   {
+      out += "Не удалось загрузить тест.\n\n";
+      return;
+   }
+   if (!result.success)
+   {
+      out += algorithm == 1 ? "Разложение LU не удалось: " : "Разложение методом Гаусса не удалось: ";
+      out += result.error;
+      out += "\n\n";
+      return;
+   }
+   if (algorithm == 1)
+   {
+      out += "Матрица L и U (вместе в LU):\n";
+      appendMatrix(out, result.matrix);
+   }
+   else
+   {
+      out += "Решение системы AX = b:\n";
+      appendVector(out, result.solution);
+   }
+   out += "Сложения: " + to_string(result.ops.additions) +
+          ", умножения: " + to_string(result.ops.multiplications) +
+          ", деления: " + to_string(result.ops.divisions) +
+          ", корни: " + to_string(result.ops.square_roots) +
+          ", перестановки: " + to_string(result.ops.swaps) + "\n\n";
+}
+
+// Этап загрузки: passes раз читает все тесты из файлов
+void pipelineLoader(const vector<TestCase> &tests, int passes, PipelineWindow &window, BoundedQueue<PipelineTask> &tasks, StageStats &stats)
+{
+   size_t index = 0;
+   for (int pass = 0; pass < passes; pass++)
+   {
+      for (const TestCase &test : tests)
+      {
+         window.acquire(index);
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         PipelineTask task;
+         task.index = index++;
+         task.test = &test;
+         int size = 0;
+         task.loaded = loadTest(test, task.A, task.b, size);
+         stats.busySeconds += secondsSince(start);
+         stats.items += 1;
+         tasks.push(move(task));
+      }
+   }
+   tasks.close();
+}
+
+// Этап решения: один из рабочих потоков, разбирающих общую очередь задач
+void pipelineSolver(int algorithm, BoundedQueue<PipelineTask> &tasks, BoundedQueue<PipelineResult> &results, StageStats &stats)
+{
+   PipelineTask task;
+   while (tasks.pop(task))
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      PipelineResult result;
+      result.index = task.index;
+      result.test = task.test;
+      result.loaded = task.loaded;
+      if (task.loaded)
+      {
+         opCount.reset();
+         if (algorithm == 1)
+         {
+            result.matrix = move(task.A);
+            result.success = LU_SQ_Decomposition(result.matrix);
+         }
+         else
+         {
+            result.success = GaussianEliminationPartialPivoting(task.A, task.b, result.solution);
+         }
+         result.ops = opCount;
+         result.error = result.success ? "" : solverError;
+      }
+      stats.busySeconds += secondsSince(start);
+      stats.items += 1;
+      results.push(move(result));
+   }
+}
+
+// Этап вывода: восстанавливает исходный порядок систем, форматирует их
+// в буфер и сбрасывает его в файл крупными блоками. В written записывается,
+// удалось ли сохранить результаты; при ошибке очередь все равно дочитывается,
+// чтобы решатели не остановились на заполненной очереди
+void pipelineWriter(int algorithm, const string &outputFile, PipelineWindow &window, BoundedQueue<PipelineResult> &results, StageStats &stats, bool &written)
+{
+   const size_t flushThreshold = 1 << 16;
+   ofstream output(outputFile);
+   map<size_t, PipelineResult> pending;
+   size_t nextIndex = 0;
+   string buffer;
+   buffer.reserve(2 * flushThreshold);
+
+   PipelineResult result;
+   while (results.pop(result))
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      size_t index = result.index;
+      pending.emplace(index, move(result));
+      window.maxPending = max(window.maxPending, pending.size());
+      size_t ready = 0;
+      for (auto it = pending.find(nextIndex); it != pending.end(); it = pending.find(nextIndex))
+      {
+         appendResult(buffer, it->second, algorithm);
+         pending.erase(it);
+         nextIndex++;
+         ready++;
+      }
+      if (ready > 0)
+      {
+         window.release(ready);
+         stats.items += ready;
+      }
+      if (buffer.size() >= flushThreshold)
+      {
+         if (output)
+            output.write(buffer.data(), buffer.size());
+         buffer.clear();
+      }
+      stats.busySeconds += secondsSince(start);
+   }
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   if (output)
+      output.write(buffer.data(), buffer.size());
+   output.close();
+   written = !output.fail();
+   stats.busySeconds += secondsSince(start);
+}
+
+// Вывод статистики этапа: занятость потоков показывает узкое место конвейера,
+// предел - пропускная способность этапа, если бы он не ждал соседей
+void printStageStats(const string &name, int threads, const StageStats &stats, double wallSeconds)
+{
+   double utilization = wallSeconds > 0 ? 100.0 * stats.busySeconds / (wallSeconds * threads) : 0.0;
+   double capacity = stats.busySeconds > 0 ? stats.items * threads / stats.busySeconds : 0.0;
+   cout << name << ": потоков " << threads
+        << ", систем " << stats.items
+        << ", работа " << fixed << setprecision(4) << stats.busySeconds << " с"
+        << ", занятость " << setprecision(1) << utilization << "%"
+        << ", предел " << setprecision(0) << capacity << " сист/с" << endl;
+}
+
+// Вывод статистики очереди между этапами
+void printQueueStats(const string &name, const QueueStats &stats)
+{
+   cout << name << ": емкость " << stats.capacity
+        << ", средняя заполненность " << fixed << setprecision(2) << stats.averageOccupancy()
+        << ", максимум " << stats.maxOccupancy
+        << ", ожиданий места " << stats.fullWaits
+        << ", ожиданий элемента " << stats.emptyWaits << endl;
+}
+
+// Наибольшее число потоков-решателей конвейера: несколько на каждое ядро.
+// Если число ядер неизвестно, считается, что ядро одно
+int maxPipelineWorkers()
+{
+   return 4 * static_cast<int>(max(1u, thread::hardware_concurrency()));
+}
+
+// Конвейерное решение потока систем: загрузчик -> workers решателей -> вывод.
+// Этапы связаны ограниченными очередями емкости queueCapacity и работают
+// одновременно. Окно упорядочивания вмещает обе полные очереди и системы,
+// которые решаются в данный момент, поэтому в обычном режиме не тормозит загрузчик
+void runPipeline(const vector<TestCase> &tests, int algorithm, int passes, int workers, size_t queueCapacity, const string &outputFile)
+{
+   BoundedQueue<PipelineTask> tasks(queueCapacity);
+   BoundedQueue<PipelineResult> results(queueCapacity);
+   PipelineWindow window(2 * queueCapacity + workers);
+   StageStats loaderStats, writerStats;
+   vector<StageStats> solverStats(workers);
+   bool written = false;
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   thread loader(pipelineLoader, cref(tests), passes, ref(window), ref(tasks), ref(loaderStats));
+   vector<thread> solvers;
+   for (int i = 0; i < workers; i++)
+   {
+      solvers.emplace_back(pipelineSolver, algorithm, ref(tasks), ref(results), ref(solverStats[i]));
+   }
+   thread writer(pipelineWriter, algorithm, cref(outputFile), ref(window), ref(results), ref(writerStats), ref(written));
+
+   loader.join();
+   for (thread &solver : solvers)
+   {
+      solver.join();
+   }
+   results.close();
+   writer.join();
+   double wallSeconds = secondsSince(start);
+
+   StageStats solverTotal;
+   for (const StageStats &stats : solverStats)
+   {
+      solverTotal += stats;
+   }
+
+   cout << "\n--- Статистика конвейера ---" << endl;
+   cout << "Обработано систем: " << writerStats.items << " за " << fixed << setprecision(4) << wallSeconds << " с" << endl;
+   if (written)
+   {
+      cout << "Результаты записаны в файл: " << outputFile << endl;
+   }
+   else
+   {
+      cout << "Не удалось записать результаты в файл: " << outputFile << endl;
+   }
+   printStageStats("Загрузка", 1, loaderStats, wallSeconds);
+   printStageStats("Решение", workers, solverTotal, wallSeconds);
+   printStageStats("Вывод", 1, writerStats, wallSeconds);
+   printQueueStats("Очередь загрузка -> решение", tasks.stats);
+   printQueueStats("Очередь решение -> вывод", results.stats);
+   cout << "Окно упорядочивания: размер " << window.size
+        << ", максимум в буфере вывода " << window.maxPending
+        << ", ожиданий загрузчика " << window.waits << endl;
+}
+
 // Основная функция с меню
 int main()
 {
@@ -512,7 +1618,8 @@ int main()
       cout << "2. Выбрать алгоритм для выполнения" << endl;
       cout << "3. Проверка по Гильберту" << endl;
       cout << "4. Вывести текущий тест" << endl;
-      cout << "4. Выход" << endl;
+      cout << "5. Конвейерный режим" << endl;
+      cout << "6. Выход" << endl;
       cout << "Ваш выбор: ";
       cin >> mainChoice;
 
@@ -565,6 +1672,7 @@ int main()
          cout << "\n--- Выбор Алгоритма ---" << endl;
          cout << "1. LU-разложение" << endl;
          cout << "2. Метод Гаусса с выбором ведущего элемента" << endl;
+         cout << "3. Пакетное решение всех тестов того же размера" << endl;
          cout << "Введите номер алгоритма для выполнения: ";
          cin >> algorithmChoice;
 
@@ -595,6 +1703,7 @@ int main()
             }
             else
             {
+               cout << solverError << endl;
                cout << "Разложение LU не удалось.\n"
                     << endl;
             }
@@ -625,12 +1734,35 @@ int main()
             }
             else
             {
+               cout << solverError << endl;
                cout << "Разложение методом Гаусса не удалось.\n"
                     << endl;
             }
             cout << "==============================================\n"
                  << endl;
          }
+         else if (algorithmChoice == 3)
+         {
+            // Пакетное решение систем того же размера, что и текущий тест
+            int copies;
+            cout << "Введите число копий каждой системы в пакете (до " << MAX_BATCH_COPIES << "): ";
+            cin >> copies;
+            if (copies < 1 || copies > MAX_BATCH_COPIES)
+            {
+               cout << "Неверное число копий. Попробуйте снова.\n"
+                    << endl;
+               continue;
+            }
+
+            cout << "\nВыполнение пакетного решения..." << endl;
+            if (!runSmallSystemBatch(tests, A.n, copies))
+            {
+               cout << "Пакетный режим доступен только для систем размером до "
+                    << MAX_FIXED_SIZE << "x" << MAX_FIXED_SIZE << "." << endl;
+            }
+            cout << "==============================================\n"
+                 << endl;
+         }
          else
          {
             cout << "Неверный выбор алгоритма. Попробуйте снова.\n"
@@ -664,7 +1796,33 @@ int main()
          cout << "\n--- Текущий Загруженный Тест ---" << endl;
          displayCurrentTest(currentTest, A, b);
       }
-      else if (mainChoice == 4)
+      else if (mainChoice == 5)
+      {
+         // Конвейерное решение потока систем из всех тестов
+         int algorithm, passes, workers;
+         int maxWorkers = maxPipelineWorkers();
+         cout << "\n--- Конвейерный Режим ---" << endl;
+         cout << "1. LU-разложение" << endl;
+         cout << "2. Метод Гаусса с выбором ведущего элемента" << endl;
+         cout << "Введите номер алгоритма для выполнения: ";
+         cin >> algorithm;
+         cout << "Введите число проходов по всем тестам: ";
+         cin >> passes;
+         cout << "Введите число потоков-решателей (до " << maxWorkers << "): ";
+         cin >> workers;
+
+         if ((algorithm != 1 && algorithm != 2) || passes < 1 || workers < 1 || workers > maxWorkers)
+         {
+            cout << "Неверные параметры конвейера. Попробуйте снова.\n"
+                 << endl;
+            continue;
+         }
+
+         runPipeline(tests, algorithm, passes, workers, 64, "pipeline_output.txt");
+         cout << "==============================================\n"
+              << endl;
+      }
+      else if (mainChoice == 6)
       {
          // Выход из программы
          cout << "Выход из программы. До свидания!" << endl;